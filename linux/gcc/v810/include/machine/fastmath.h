@@ -98,3 +98,35 @@ float EXFUN(fast_logef,(float));
 /* Override the functions defined in math.h */
 #endif /* __sysvnecv70_target */
 
+
+#ifdef __v810
+/* Table driven and written for the FPU of the V810, in fastmath.s of the
+   VUEngine tools. The x versions take and return fix19_13 values, with
+   angles in 65536ths of a turn.  */
+
+float EXFUN(fast_sinf,(float));
+float EXFUN(fast_cosf,(float));
+float EXFUN(fast_atan2f,(float, float));
+float EXFUN(fast_sqrtf,(float));
+float EXFUN(fast_expf,(float));
+
+int EXFUN(fast_sinx,(int));
+int EXFUN(fast_cosx,(int));
+int EXFUN(fast_atan2x,(int, int));
+int EXFUN(fast_sqrtx,(int));
+int EXFUN(fast_expx,(int));
+
+#define	sinf(x)		fast_sinf(x)
+#define	cosf(x)		fast_cosf(x)
+#define	atan2f(y,x)	fast_atan2f(y,x)
+#define	sqrtf(x)	fast_sqrtf(x)
+#define	expf(x)		fast_expf(x)
+
+#ifdef _DOUBLE_IS_32BITS
+#define	sin(x)		fast_sinf(x)
+#define	cos(x)		fast_cosf(x)
+#define	atan2(y,x)	fast_atan2f(y,x)
+#define	sqrt(x)		fast_sqrtf(x)
+#define	exp(x)		fast_expf(x)
+#endif
+#endif /* __v810 */
@@ -0,0 +1,14 @@
+#ifndef COMPRESS_H_
+#define COMPRESS_H_
+
+// Marks a global array, after its declarator, to be compressed by v810-compress
+#define LZ77_COMPRESSED(name)		__attribute__((section(".lz77." #name)))
+#define RLE_COMPRESSED(name)		__attribute__((section(".rle." #name)))
+
+// Size of the data of a compressed array once decompressed
+#define DECOMPRESSED_SIZE(source)	(*(const unsigned int*)(source) >> 8)
+
+void lz77_decompress(const void* source, void* destination);
+void rle_decompress(const void* source, void* destination);
+
+#endif
@@ -0,0 +1,110 @@
+/*
+ * Decompressors for the arrays compressed by v810-compress
+ *
+ * The streams are in the LZ77 and RLE formats of the GBA BIOS: a word with the method in its
+ * low byte and the size once decompressed above it, followed by the compressed bytes. They are
+ * written a byte at a time, so the destination can be WRAM or the CHR and BGMAP memory of the
+ * VIP, and LZ77 reads its matches back from the destination instead of from a buffer.
+ *
+ * Build:
+ *     v810-as decompress.s -o decompress.o
+ * and link decompress.o with the game.
+ */
+
+	.section .text
+
+/*
+ * void lz77_decompress(const void* source, void* destination)
+ *
+ * Each flag byte announces eight blocks, from its highest bit: a clear bit is a literal byte,
+ * a set one two bytes with the length minus 3 in the high nibble and the distance back minus 1
+ * in the remaining 12 bits.
+ */
+	.global	_lz77_decompress
+_lz77_decompress:
+	ld.w	0[r6], r10
+	shr	8, r10
+	add	r7, r10				# end of the destination
+	add	4, r6
+	br	5f
+
+1:	ld.b	0[r6], r11			# flags
+	add	1, r6
+	movea	0x80, r0, r12
+2:	cmp	r10, r7
+	bnl	6f
+	mov	r11, r13
+	and	r12, r13
+	bne	3f
+	ld.b	0[r6], r13			# literal
+	st.b	r13, 0[r7]
+	add	1, r6
+	add	1, r7
+	br	4f
+
+3:	ld.b	0[r6], r14			# match
+	ld.b	1[r6], r15
+	add	2, r6
+	andi	0xFF, r14, r14
+	andi	0xFF, r15, r15
+	mov	r14, r16
+	shr	4, r16
+	add	3, r16				# length
+	andi	0x0F, r14, r14
+	shl	8, r14
+	or	r15, r14
+	add	1, r14				# distance
+	mov	r7, r17
+	sub	r14, r17
+7:	ld.b	0[r17], r13
+	st.b	r13, 0[r7]
+	add	1, r17
+	add	1, r7
+	add	-1, r16
+	bne	7b
+
+4:	shr	1, r12
+	bne	2b
+5:	cmp	r10, r7
+	bl	1b
+6:	jmp	[lp]
+
+/*
+ * void rle_decompress(const void* source, void* destination)
+ *
+ * A byte with its highest bit set is followed by a byte to repeat 3 to 130 times, given by the
+ * other bits plus 3; otherwise it is followed by 1 to 128 bytes to copy, the other bits plus 1.
+ */
+	.global	_rle_decompress
+_rle_decompress:
+	ld.w	0[r6], r10
+	shr	8, r10
+	add	r7, r10				# end of the destination
+	add	4, r6
+	br	4f
+
+1:	ld.b	0[r6], r11
+	add	1, r6
+	andi	0x7F, r11, r12
+	cmp	0, r11
+	blt	3f
+	add	1, r12				# bytes to copy
+2:	ld.b	0[r6], r13
+	st.b	r13, 0[r7]
+	add	1, r6
+	add	1, r7
+	add	-1, r12
+	bne	2b
+	br	4f
+
+3:	add	3, r12				# run
+	ld.b	0[r6], r13
+	add	1, r6
+5:	st.b	r13, 0[r7]
+	add	1, r7
+	add	-1, r12
+	bne	5b
+
+4:	cmp	r10, r7
+	bl	1b
+	jmp	[lp]
@@ -0,0 +1,83 @@
+/*
+ * Startup code for the Virtual Boy
+ *
+ * Initializes memory from the table that vb_shipping.ld emits between __initTable and
+ * __initTableEnd, three words per section: the address of its contents in ROM (0 to zero it),
+ * its start and its end. Every section is moved with a single bit string instruction instead
+ * of a loop of loads and stores.
+ *
+ * The sections in SRAM, from __sramInitTable on, hold the save data and are left alone unless
+ * the game is linked with --defsym __sramPreserve=0.
+ *
+ * The constructors that vb_shipping.ld collects between __ctorsStart and __ctorsEnd, such as
+ * the ones that register the objects of a profiling build, then run before main().
+ *
+ * Build:
+ *     v810-as crt0.s -o crt0.o
+ * and link crt0.o first, with -nostartfiles.
+ */
+
+	.section .text
+
+	.global	_start
+_start:
+	movea	0x1000, r0, r1			# interrupts stay masked until main() installs handlers
+	ldsr	r1, psw
+	mov	2, r1				# enable the instruction cache
+	ldsr	r1, chcw
+	movhi	hi(__stack), r0, sp
+	movea	lo(__stack), sp, sp
+	movhi	hi(__gp), r0, gp
+	movea	lo(__gp), gp, gp
+
+	movhi	hi(__initTable), r0, r20
+	movea	lo(__initTable), r20, r20
+	movhi	hi(__sramInitTable), r0, r21
+	movea	lo(__sramInitTable), r21, r21
+	movea	lo(__sramPreserve), r0, r10
+	cmp	0, r10
+	bne	3f
+	movhi	hi(__initTableEnd), r0, r21
+	movea	lo(__initTableEnd), r21, r21
+	br	3f
+
+1:	ld.w	0[r20], r30			# source
+	ld.w	4[r20], r29			# destination
+	ld.w	8[r20], r28			# end
+	add	12, r20
+	sub	r29, r28
+	shl	3, r28				# length in bits
+	andi	3, r29, r26			# word addresses and bit offsets
+	xor	r26, r29
+	shl	3, r26
+	cmp	0, r30
+	be	2f
+	andi	3, r30, r27
+	xor	r27, r30
+	shl	3, r27
+	movbsu
+	br	3f
+
+2:	mov	r26, r27			# zeroed as destination ^ destination
+	mov	r29, r30
+	xorbsu
+
+3:	cmp	r21, r20
+	bl	1b
+
+	movhi	hi(__ctorsStart), r0, r28
+	movea	lo(__ctorsStart), r28, r28
+	movhi	hi(__ctorsEnd), r0, r29
+	movea	lo(__ctorsEnd), r29, r29
+	br	6f
+5:	add	-4, r29				# .ctors runs from last to first
+	ld.w	0[r29], r10
+	jal	7f
+7:	add	4, lp
+	jmp	[r10]
+6:	cmp	r28, r29
+	bh	5b
+
+	jal	_main
+4:	halt
+	br	4b
@@ -0,0 +1,18 @@
+#ifndef OVERLAY_H_
+#define OVERLAY_H_
+
+// Symbols that v810-overlay defines for the overlay of a state
+#define OVERLAY_DECLARE(state)																		\
+	extern const char _load_start_overlay_##state[];												\
+	extern char _overlay##state##Start[], _overlay##state##DataEnd[], _overlay##state##Bss[],		\
+		_overlay##state##End[]
+
+// Reinitializes the data of a state, to be called when the state is entered. OVERLAY_DECLARE(state)
+// must come first
+#define OVERLAY_LOAD(state)																			\
+	__overlay_load(_load_start_overlay_##state, _overlay##state##Start, _overlay##state##DataEnd,	\
+		_overlay##state##Bss, _overlay##state##End)
+
+void __overlay_load(const void* lma, void* start, void* dataEnd, void* bss, void* end);
+
+#endif
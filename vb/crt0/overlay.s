@@ -0,0 +1,36 @@
+/*
+ * Loader for the per-state data overlays
+ *
+ * v810-overlay lays out the .data of the objects of each game state at the same WRAM address,
+ * after .wram_text, and their .bss at the same address after that. Only one state owns that memory at a time, so its data has to be
+ * reinitialized from ROM whenever the state is entered, with OVERLAY_LOAD() from overlay.h.
+ *
+ * Build:
+ *     v810-as overlay.s -o overlay.o
+ * and link overlay.o with the game.
+ */
+
+	.section .text
+
+/*
+ * void __overlay_load(const void* lma, void* start, void* dataEnd, void* bss, void* end)
+ *
+ * Copies the initialized data of an overlay from lma to start up to dataEnd and zeroes its .bss
+ * from bss up to end. v810-overlay keeps all of them word aligned.
+ */
+	.global	___overlay_load
+___overlay_load:
+	ld.w	0[sp], r11			# end
+	br	2f
+1:	ld.w	0[r6], r10
+	st.w	r10, 0[r7]
+	add	4, r6
+	add	4, r7
+2:	cmp	r8, r7
+	bl	1b
+	br	4f
+3:	st.w	r0, 0[r9]
+	add	4, r9
+4:	cmp	r11, r9
+	bl	3b
+	jmp	[lp]
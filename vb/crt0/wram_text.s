@@ -0,0 +1,37 @@
+/*
+ * Loader for the code that runs from WRAM
+ *
+ * Functions placed in .wram_text, with __attribute__((section(".wram_text"))) or by renaming
+ * their sections after v810-wram, are linked by vb_shipping.ld to run from WRAM while they are
+ * stored in ROM after the initialized data. The startup code has to copy them before main();
+ * crt0.s in this directory does so through the table of vb_shipping.ld.
+ *
+ * Build:
+ *     v810-as wram_text.s -o wram_text.o
+ * and link wram_text.o with the game.
+ */
+
+	.section .text
+
+/*
+ * void __wram_text_init(void)
+ *
+ * Copies .wram_text from __wramTextLma to __wramTextStart. Call it from crt0 after the data
+ * sections are initialized.
+ */
+	.global	___wram_text_init
+___wram_text_init:
+	movhi	hi(__wramTextLma), r0, r6
+	movea	lo(__wramTextLma), r6, r6
+	movhi	hi(__wramTextStart), r0, r7
+	movea	lo(__wramTextStart), r7, r7
+	movhi	hi(__wramTextEnd), r0, r8
+	movea	lo(__wramTextEnd), r8, r8
+	br	2f
+1:	ld.w	0[r6], r10			# both ends are word aligned by vb_shipping.ld
+	st.w	r10, 0[r7]
+	add	4, r6
+	add	4, r7
+2:	cmp	r8, r7
+	bl	1b
+	jmp	[lp]
@@ -0,0 +1,420 @@
+/*
+ * Fast float and fixed point math for the V810
+ *
+ * Table driven sinf, cosf, atan2f, sqrtf and expf on the FPU of the V810, declared in
+ * machine/fastmath.h as fast_sinf and so on, and their fix19_13 siblings fast_sinx and so on,
+ * whose angles are in 65536ths of a turn. The tables are sampled finely enough for a linear
+ * interpolation between two entries to stay within 1e-4 of the result, which is plenty for
+ * positions and rotations on screen and avoids the series of newlib, which runs through the
+ * software floating point of libgcc. sqrtf refines the estimate of its reciprocal with three
+ * Newton steps of mulf.s instead of dividing. Infinities and NaN are only handled by sqrtf, and
+ * atan2f gives 0 for both zeros whatever their signs.
+ *
+ * Build:
+ *     v810-as fastmath.s -o fastmath.o
+ * and link fastmath.o with the game, before libm.
+ */
+
+	.section .text
+
+/*
+ * float fast_sinf(float x)
+ * float fast_cosf(float x)
+ *
+ * x is scaled to 256 steps per turn, whose fraction interpolates between the entries of a
+ * quarter of a sine. The quarters that go back down read the table backward, and the second
+ * half of the turn is the first one negated.
+ */
+	.global	_fast_sinf
+_fast_sinf:
+	mov	r0, r12
+	br	1f
+
+	.global	_fast_cosf
+_fast_cosf:
+	movea	64, r0, r12
+1:	movhi	hi(0x4222F983), r0, r11		# 256 / 2pi
+	movea	lo(0x4222F983), r11, r11
+	mulf.s	r6, r11
+	trnc.sw	r11, r13
+	cvt.ws	r13, r14
+	subf.s	r14, r11
+	cmpf.s	r0, r11
+	bge	2f
+	add	-1, r13
+	movhi	0x3F80, r0, r14			# 1.0
+	addf.s	r14, r11
+2:	add	r12, r13
+	andi	255, r13, r13
+	andi	63, r13, r14
+	movhi	hi(.Lsines), r0, r15
+	movea	lo(.Lsines), r15, r15
+	andi	64, r13, r16
+	be	3f
+	movea	64, r0, r16
+	sub	r14, r16
+	shl	2, r16
+	add	r16, r15
+	ld.w	0[r15], r16
+	ld.w	-4[r15], r17
+	br	4f
+3:	shl	2, r14
+	add	r14, r15
+	ld.w	0[r15], r16
+	ld.w	4[r15], r17
+4:	subf.s	r16, r17
+	mulf.s	r11, r17
+	addf.s	r16, r17
+	mov	r17, r10
+	andi	128, r13, r13
+	be	5f
+	movhi	0x8000, r0, r11
+	xor	r11, r10
+5:	jmp	[lp]
+
+/*
+ * float fast_atan2f(float y, float x)
+ *
+ * The smaller of |y| and |x| over the larger is looked up in a table of atan between 0 and 1,
+ * and the result moved to the octant of the operands.
+ */
+	.global	_fast_atan2f
+_fast_atan2f:
+	mov	r6, r12
+	shl	1, r12
+	shr	1, r12
+	mov	r7, r13
+	shl	1, r13
+	shr	1, r13
+	mov	r12, r10
+	or	r13, r10
+	be	9f
+	mov	r0, r19
+	cmp	r13, r12
+	bh	1f
+	divf.s	r13, r12
+	br	2f
+1:	divf.s	r12, r13
+	mov	r13, r12
+	mov	1, r19
+2:	movhi	0x4280, r0, r14			# 64.0
+	mulf.s	r12, r14
+	trnc.sw	r14, r15
+	cvt.ws	r15, r16
+	subf.s	r16, r14
+	shl	2, r15
+	movhi	hi(.Latans), r15, r15
+	movea	lo(.Latans), r15, r15
+	ld.w	0[r15], r16
+	ld.w	4[r15], r10
+	subf.s	r16, r10
+	mulf.s	r14, r10
+	addf.s	r16, r10
+	cmp	0, r19
+	be	3f
+	movhi	hi(0x3FC90FDB), r0, r11		# pi / 2
+	movea	lo(0x3FC90FDB), r11, r11
+	subf.s	r10, r11
+	mov	r11, r10
+3:	cmp	0, r7
+	bge	4f
+	movhi	hi(0x40490FDB), r0, r11		# pi
+	movea	lo(0x40490FDB), r11, r11
+	subf.s	r10, r11
+	mov	r11, r10
+4:	cmp	0, r6
+	bge	9f
+	movhi	0x8000, r0, r11
+	xor	r11, r10
+9:	jmp	[lp]
+
+/*
+ * float fast_sqrtf(float x)
+ *
+ * x times its reciprocal square root, from the estimate that halving the bits of a float gives
+ * and y = y * (1.5 - x / 2 * y * y). x is first scaled by an even power of two to between 1
+ * and 4, where y * y can neither overflow nor underflow, and the result by half that power.
+ * Zeros, infinities and NaN are returned as they are, denormals, which the FPU does not take,
+ * give 0 and negative numbers give NaN.
+ */
+	.global	_fast_sqrtf
+_fast_sqrtf:
+	mov	r6, r10
+	shl	1, r10
+	be	8f
+	cmp	0, r6
+	blt	9f
+	movhi	0x7F80, r0, r11
+	cmp	r11, r6
+	bnl	8f
+	mov	r6, r17
+	shr	23, r17
+	be	7f
+	addi	-127, r17, r17
+	sar	1, r17				# half the power of two
+	mov	r17, r11
+	shl	24, r11
+	sub	r11, r6
+	mov	r6, r11
+	shr	1, r11
+	movhi	hi(0x5F3759DF), r0, r12
+	movea	lo(0x5F3759DF), r12, r12
+	sub	r11, r12
+	movhi	0x3F00, r0, r13			# 0.5
+	mulf.s	r6, r13
+	movhi	0x3FC0, r0, r14			# 1.5
+	mov	3, r15
+1:	mov	r12, r11
+	mulf.s	r12, r11
+	mulf.s	r13, r11
+	mov	r14, r16
+	subf.s	r11, r16
+	mulf.s	r16, r12
+	add	-1, r15
+	bne	1b
+	mulf.s	r6, r12
+	shl	23, r17
+	add	r17, r12
+	mov	r12, r10
+	jmp	[lp]
+7:	mov	r0, r10
+	jmp	[lp]
+8:	mov	r6, r10
+	jmp	[lp]
+9:	movhi	0x7FC0, r0, r10
+	jmp	[lp]
+
+/*
+ * float fast_expf(float x)
+ *
+ * 2 to the power of x / ln 2, in 32 steps per power of two: the fraction interpolates between
+ * the entries of a table of 2^(k/32), and the power of two goes to the exponent. Results
+ * beyond the range of a float give infinity or zero.
+ */
+	.global	_fast_expf
+_fast_expf:
+	movhi	0x42C8, r0, r11			# 100.0
+	cmpf.s	r11, r6
+	bgt	8f
+	movhi	0xC2C8, r0, r11			# -100.0
+	cmpf.s	r11, r6
+	blt	9f
+	movhi	hi(0x4238AA3B), r0, r11		# 32 / ln 2
+	movea	lo(0x4238AA3B), r11, r11
+	mulf.s	r6, r11
+	trnc.sw	r11, r12
+	cvt.ws	r12, r13
+	subf.s	r13, r11
+	cmpf.s	r0, r11
+	bge	1f
+	add	-1, r12
+	movhi	0x3F80, r0, r13			# 1.0
+	addf.s	r13, r11
+1:	andi	31, r12, r13
+	sar	5, r12
+	movea	127, r0, r14
+	cmp	r14, r12
+	bgt	8f
+	movea	-126, r0, r14
+	cmp	r14, r12
+	blt	9f
+	shl	2, r13
+	movhi	hi(.Lexps), r13, r13
+	movea	lo(.Lexps), r13, r13
+	ld.w	0[r13], r14
+	ld.w	4[r13], r10
+	subf.s	r14, r10
+	mulf.s	r11, r10
+	addf.s	r14, r10
+	shl	23, r12
+	add	r12, r10
+	jmp	[lp]
+8:	movhi	0x7F80, r0, r10
+	jmp	[lp]
+9:	mov	r0, r10
+	jmp	[lp]
+
+/*
+ * int fast_sinx(int angle)
+ * int fast_cosx(int angle)
+ *
+ * As fast_sinf with integers: the angle is in 65536ths of a turn, its high byte picks the
+ * entry of a quarter of a sine in 1.15 and its low byte interpolates. The result is in
+ * fix19_13.
+ */
+	.global	_fast_sinx
+_fast_sinx:
+	mov	r0, r12
+	br	1f
+
+	.global	_fast_cosx
+_fast_cosx:
+	movea	0x4000, r0, r12
+1:	add	r12, r6
+	andi	255, r6, r11
+	shr	8, r6
+	andi	255, r6, r13
+	andi	63, r13, r14
+	movhi	hi(.Lsinesx), r0, r15
+	movea	lo(.Lsinesx), r15, r15
+	andi	64, r13, r16
+	be	3f
+	movea	64, r0, r16
+	sub	r14, r16
+	shl	1, r16
+	add	r16, r15
+	in.h	0[r15], r16
+	in.h	-2[r15], r17
+	br	4f
+3:	shl	1, r14
+	add	r14, r15
+	in.h	0[r15], r16
+	in.h	2[r15], r17
+4:	sub	r16, r17
+	mul	r11, r17
+	sar	8, r17
+	add	r16, r17
+	add	2, r17
+	sar	2, r17
+	mov	r17, r10
+	andi	128, r13, r13
+	be	5f
+	not	r10, r10
+	add	1, r10
+5:	jmp	[lp]
+
+/*
+ * int fast_atan2x(int y, int x)
+ *
+ * The angle of y and x, in any fixed point format as long as it is the same, in 65536ths of a
+ * turn between -32768 and 32768.
+ */
+	.global	_fast_atan2x
+_fast_atan2x:
+	addi	-4, sp, sp
+	st.w	lp, 0[sp]
+	cvt.ws	r6, r6
+	cvt.ws	r7, r7
+	jal	_fast_atan2f
+	movhi	hi(0x4622F983), r0, r11		# 32768 / pi
+	movea	lo(0x4622F983), r11, r11
+	mulf.s	r11, r10
+	cvt.sw	r10, r10
+	ld.w	0[sp], lp
+	addi	4, sp, sp
+	jmp	[lp]
+
+/*
+ * int fast_sqrtx(int x)
+ *
+ * The square root of a fix19_13, which is that of x * 8192. Zero for negative numbers.
+ */
+	.global	_fast_sqrtx
+_fast_sqrtx:
+	mov	r0, r10
+	cmp	0, r6
+	ble	1f
+	addi	-4, sp, sp
+	st.w	lp, 0[sp]
+	cvt.ws	r6, r6
+	movhi	0x4600, r0, r11			# 8192.0
+	mulf.s	r11, r6
+	jal	_fast_sqrtf
+	cvt.sw	r10, r10
+	ld.w	0[sp], lp
+	addi	4, sp, sp
+1:	jmp	[lp]
+
+/*
+ * int fast_expx(int x)
+ *
+ * e to the power of a fix19_13, saturated to the largest fix19_13 from about 12.48.
+ */
+	.global	_fast_expx
+_fast_expx:
+	movhi	hi(102208), r0, r11
+	movea	lo(102208), r11, r11
+	cmp	r11, r6
+	ble	1f
+	movhi	0x8000, r0, r10
+	add	-1, r10
+	jmp	[lp]
+1:	addi	-4, sp, sp
+	st.w	lp, 0[sp]
+	cvt.ws	r6, r6
+	movhi	0x3900, r0, r11			# 1 / 8192
+	mulf.s	r11, r6
+	jal	_fast_expf
+	movhi	0x4600, r0, r11			# 8192.0
+	mulf.s	r11, r10
+	cvt.sw	r10, r10
+	ld.w	0[sp], lp
+	addi	4, sp, sp
+	jmp	[lp]
+
+	.section .rodata
+	.align	2
+
+	# sin(k * pi / 128), k = 0..64
+.Lsines:
+	.float	0, 0.0245412285, 0.0490676743, 0.0735645636
+	.float	0.0980171403, 0.122410675, 0.146730474, 0.170961889
+	.float	0.195090322, 0.21910124, 0.24298018, 0.266712757
+	.float	0.290284677, 0.31368174, 0.336889853, 0.359895037
+	.float	0.382683432, 0.405241314, 0.427555093, 0.44961133
+	.float	0.471396737, 0.492898192, 0.514102744, 0.53499762
+	.float	0.555570233, 0.575808191, 0.595699304, 0.615231591
+	.float	0.634393284, 0.653172843, 0.671558955, 0.689540545
+	.float	0.707106781, 0.724247083, 0.740951125, 0.757208847
+	.float	0.773010453, 0.788346428, 0.803207531, 0.817584813
+	.float	0.831469612, 0.844853565, 0.85772861, 0.870086991
+	.float	0.881921264, 0.893224301, 0.903989293, 0.914209756
+	.float	0.923879533, 0.932992799, 0.941544065, 0.949528181
+	.float	0.956940336, 0.963776066, 0.970031253, 0.97570213
+	.float	0.98078528, 0.985277642, 0.98917651, 0.992479535
+	.float	0.995184727, 0.997290457, 0.998795456, 0.999698819
+	.float	1
+
+	# atan(k / 64), k = 0..65, the last one read with a fraction of zero at 1
+.Latans:
+	.float	0, 0.0156237286, 0.0312398334, 0.0468407129
+	.float	0.06241881, 0.0779666338, 0.0934767812, 0.108941957
+	.float	0.124354995, 0.139708874, 0.154996742, 0.170211925
+	.float	0.18534795, 0.200398554, 0.2153577, 0.230219587
+	.float	0.244978663, 0.259629629, 0.274167451, 0.288587362
+	.float	0.302884868, 0.317055753, 0.331096077, 0.345002177
+	.float	0.35877067, 0.372398447, 0.385882669, 0.39922077
+	.float	0.412410442, 0.425449637, 0.43833656, 0.451069656
+	.float	0.463647609, 0.47606933, 0.488333951, 0.500440813
+	.float	0.51238946, 0.524179629, 0.535811238, 0.547284381
+	.float	0.558599315, 0.569756453, 0.580756354, 0.59159971
+	.float	0.602287346, 0.612820202, 0.62319933, 0.633425883
+	.float	0.643501109, 0.653426341, 0.663202993, 0.672832548
+	.float	0.682316555, 0.691656622, 0.700854408, 0.709911618
+	.float	0.71883, 0.727611333, 0.736257429, 0.744770126
+	.float	0.753151281, 0.76140277, 0.76952648, 0.77752431
+	.float	0.785398163, 0.793149946
+
+	# 2^(k / 32), k = 0..32
+.Lexps:
+	.float	1, 1.02189715, 1.04427378, 1.0671404
+	.float	1.09050773, 1.11438674, 1.13878863, 1.16372486
+	.float	1.18920712, 1.21524736, 1.24185781, 1.26905096
+	.float	1.29683955, 1.32523664, 1.35425555, 1.38390988
+	.float	1.41421356, 1.44518081, 1.47682615, 1.50916443
+	.float	1.54221083, 1.57598085, 1.61049033, 1.64575548
+	.float	1.68179283, 1.7186193, 1.75625216, 1.79470908
+	.float	1.83400809, 1.87416763, 1.91520656, 1.95714412
+	.float	2
+
+	# sin(k * pi / 128) in 1.15, k = 0..64, 32768 read without its sign by in.h
+.Lsinesx:
+	.hword	0, 804, 1608, 2411, 3212, 4011, 4808, 5602
+	.hword	6393, 7180, 7962, 8740, 9512, 10279, 11039, 11793
+	.hword	12540, 13279, 14010, 14733, 15447, 16151, 16846, 17531
+	.hword	18205, 18868, 19520, 20160, 20788, 21403, 22006, 22595
+	.hword	23170, 23732, 24279, 24812, 25330, 25833, 26320, 26791
+	.hword	27246, 27684, 28106, 28511, 28899, 29269, 29622, 29957
+	.hword	30274, 30572, 30853, 31114, 31357, 31581, 31786, 31972
+	.hword	32138, 32286, 32413, 32522, 32610, 32679, 32729, 32758
+	.hword	32768
@@ -0,0 +1,45 @@
+#ifndef FIBER_H_
+#define FIBER_H_
+
+// Cooperative fibers, implemented in fiber.s. A fiber runs its function on a stack of its own
+// from the first fiber_resume until it calls fiber_yield, and carries on after that call on the
+// next fiber_resume, until its function returns:
+//
+//	void walk(void* data)
+//	{
+//		Actor actor = data;
+//
+//		for(int i = 0; i < 60; i++)
+//		{
+//			Actor::move(actor);
+//			fiber_yield();
+//		}
+//	}
+//
+//	Fiber* fiber = fiber_create(walk, actor);
+//
+// and fiber_resume(fiber) once per frame until fiber->state is FIBER_DONE.
+
+#define FIBER_FREE		0
+#define FIBER_ALIVE		1
+#define FIBER_DONE		2
+
+typedef struct Fiber
+{
+	void* stack;
+	void* resumer;
+	void (*function)(void* data);
+	void* data;
+	int state;
+	struct Fiber* previous;
+} Fiber;
+
+// Fiber that is running, NULL outside of fibers
+extern Fiber* fiber_current;
+
+Fiber* fiber_create(void (*function)(void* data), void* data);
+void fiber_resume(Fiber* fiber);
+void fiber_yield(void);
+void fiber_destroy(Fiber* fiber);
+
+#endif
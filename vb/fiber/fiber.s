@@ -0,0 +1,192 @@
+/*
+ * Cooperative fibers for the V810
+ *
+ * A fiber runs a function on a stack of its own until it yields, and carries on from there the
+ * next time it is resumed, so that a script can wait for frames and events in sequence instead
+ * of being split over messages and delayed telegrams. Switching saves what a jmp_buf would hold,
+ * the registers that calls preserve, r2, r20 to r29 and lp, on the stack that is left, keeps
+ * the stack pointer in the fiber and restores the same from the stack that is entered.
+ *
+ * The fibers and their stacks come from a pool in .bss, in WRAM, of FIBERS stacks of
+ * FIBER_STACK_SIZE bytes, 8 of 512 bytes unless they are defined when assembling.
+ *
+ * Build:
+ *     v810-as fiber.s -o fiber.o
+ * or, for other sizes,
+ *     v810-as --defsym FIBERS=16 --defsym FIBER_STACK_SIZE=1024 fiber.s -o fiber.o
+ * and link fiber.o with the game.
+ */
+
+	.ifndef	FIBERS
+	.set	FIBERS, 8
+	.endif
+	.ifndef	FIBER_STACK_SIZE
+	.set	FIBER_STACK_SIZE, 512
+	.endif
+
+	# Offsets in a Fiber, as in fiber.h
+	.set	STACK, 0
+	.set	RESUMER, 4
+	.set	FUNCTION, 8
+	.set	DATA, 12
+	.set	STATE, 16
+	.set	PREVIOUS, 20
+	.set	FIBER_SIZE, 24
+
+	.set	FREE, 0
+	.set	ALIVE, 1
+	.set	DONE, 2
+
+	# Registers saved on a stack that is left
+	.set	FRAME, 48
+
+	.macro	save
+	addi	-FRAME, sp, sp
+	st.w	lp, 0[sp]
+	st.w	r2, 4[sp]
+	st.w	r20, 8[sp]
+	st.w	r21, 12[sp]
+	st.w	r22, 16[sp]
+	st.w	r23, 20[sp]
+	st.w	r24, 24[sp]
+	st.w	r25, 28[sp]
+	st.w	r26, 32[sp]
+	st.w	r27, 36[sp]
+	st.w	r28, 40[sp]
+	st.w	r29, 44[sp]
+	.endm
+
+	.macro	restore
+	ld.w	0[sp], lp
+	ld.w	4[sp], r2
+	ld.w	8[sp], r20
+	ld.w	12[sp], r21
+	ld.w	16[sp], r22
+	ld.w	20[sp], r23
+	ld.w	24[sp], r24
+	ld.w	28[sp], r25
+	ld.w	32[sp], r26
+	ld.w	36[sp], r27
+	ld.w	40[sp], r28
+	ld.w	44[sp], r29
+	addi	FRAME, sp, sp
+	.endm
+
+	.section .text
+
+/*
+ * Fiber* fiber_create(void (*function)(void* data), void* data)
+ *
+ * Takes a free fiber from the pool, or returns NULL when there is none. Its stack starts with
+ * a frame whose lp enters .Lstart on the first resume.
+ */
+	.global	_fiber_create
+_fiber_create:
+	movhi	hi(.Lfibers), r0, r10
+	movea	lo(.Lfibers), r10, r10
+	movhi	hi(.Lstacks + FIBER_STACK_SIZE), r0, r11
+	movea	lo(.Lstacks + FIBER_STACK_SIZE), r11, r11
+	movhi	hi(FIBER_STACK_SIZE), r0, r12
+	movea	lo(FIBER_STACK_SIZE), r12, r12
+	movea	FIBERS, r0, r13
+1:	ld.w	STATE[r10], r14
+	cmp	FREE, r14
+	be	2f
+	addi	FIBER_SIZE, r10, r10
+	add	r12, r11
+	add	-1, r13
+	bne	1b
+	mov	r0, r10
+	jmp	[lp]
+2:	st.w	r6, FUNCTION[r10]
+	st.w	r7, DATA[r10]
+	mov	ALIVE, r14
+	st.w	r14, STATE[r10]
+	addi	-FRAME, r11, r11
+	movhi	hi(.Lstart), r0, r14
+	movea	lo(.Lstart), r14, r14
+	st.w	r14, 0[r11]
+	st.w	r11, STACK[r10]
+	jmp	[lp]
+
+/*
+ * void fiber_resume(Fiber* fiber)
+ *
+ * Runs the fiber until it yields or returns. Fibers can resume other fibers, which yield back
+ * to them. Fibers that are done are not resumed.
+ */
+	.global	_fiber_resume
+_fiber_resume:
+	ld.w	STATE[r6], r10
+	cmp	ALIVE, r10
+	bne	1f
+	save
+	st.w	sp, RESUMER[r6]
+	movhi	hi(_fiber_current), r0, r10
+	movea	lo(_fiber_current), r10, r10
+	ld.w	0[r10], r11
+	st.w	r11, PREVIOUS[r6]
+	st.w	r6, 0[r10]
+	ld.w	STACK[r6], sp
+	restore
+1:	jmp	[lp]
+
+/*
+ * void fiber_yield(void)
+ *
+ * Returns from the fiber_resume that entered the current fiber, and does nothing outside of
+ * fibers.
+ */
+	.global	_fiber_yield
+_fiber_yield:
+	movhi	hi(_fiber_current), r0, r10
+	movea	lo(_fiber_current), r10, r10
+	ld.w	0[r10], r6
+	cmp	0, r6
+	be	1f
+	save
+	st.w	sp, STACK[r6]
+.Lleave:
+	ld.w	PREVIOUS[r6], r11
+	st.w	r11, 0[r10]
+	ld.w	RESUMER[r6], sp
+	restore
+1:	jmp	[lp]
+
+/*
+ * void fiber_destroy(Fiber* fiber)
+ *
+ * Returns a fiber to the pool, whether it is done or waiting to be resumed.
+ */
+	.global	_fiber_destroy
+_fiber_destroy:
+	st.w	r0, STATE[r6]
+	jmp	[lp]
+
+	# First resume of a fiber: calls its function, then marks it done and leaves it for good
+.Lstart:
+	movhi	hi(_fiber_current), r0, r10
+	movea	lo(_fiber_current), r10, r10
+	ld.w	0[r10], r10
+	ld.w	DATA[r10], r6
+	ld.w	FUNCTION[r10], r11
+	movhi	hi(1f), r0, lp
+	movea	lo(1f), lp, lp
+	jmp	[r11]
+1:	movhi	hi(_fiber_current), r0, r10
+	movea	lo(_fiber_current), r10, r10
+	ld.w	0[r10], r6
+	mov	DONE, r11
+	st.w	r11, STATE[r6]
+	br	.Lleave
+
+	.section .bss
+	.align	2
+
+	.global	_fiber_current
+_fiber_current:
+	.space	4
+.Lfibers:
+	.space	FIBERS * FIBER_SIZE
+.Lstacks:
+	.space	FIBERS * FIBER_STACK_SIZE
@@ -0,0 +1,98 @@
+#ifndef FIXED_H_
+#define FIXED_H_
+
+// Multiplications and divisions of the fixed point formats of the engine. The compiler of the
+// toolchain is built without fixed point support, so the _Accum and _Fract types of stdfix.h
+// are not available. The product of two words is taken from mul, which leaves its high word in
+// r30, instead of widening the operands to long long. The saturating forms clamp to the limits
+// of the format instead of wrapping around.
+
+#define FIX7_9_MAX		((short)0x7FFF)
+#define FIX7_9_MIN		((short)0x8000)
+#define FIX10_6_MAX		((short)0x7FFF)
+#define FIX10_6_MIN		((short)0x8000)
+#define FIX19_13_MAX	((int)0x7FFFFFFF)
+#define FIX19_13_MIN	((int)0x80000000)
+
+static inline short fix16_saturate(int value)
+{
+	return value > 0x7FFF ? 0x7FFF : value < -0x8000 ? -0x8000 : value;
+}
+
+static inline short fix7_9_mul(short a, short b)
+{
+	return (a * b) >> 9;
+}
+
+static inline short fix7_9_mul_sat(short a, short b)
+{
+	return fix16_saturate((a * b) >> 9);
+}
+
+static inline short fix7_9_div(short a, short b)
+{
+	return (a << 9) / b;
+}
+
+static inline short fix7_9_div_sat(short a, short b)
+{
+	return fix16_saturate((a << 9) / b);
+}
+
+static inline short fix10_6_mul(short a, short b)
+{
+	return (a * b) >> 6;
+}
+
+static inline short fix10_6_mul_sat(short a, short b)
+{
+	return fix16_saturate((a * b) >> 6);
+}
+
+static inline short fix10_6_div(short a, short b)
+{
+	return (a << 6) / b;
+}
+
+static inline short fix10_6_div_sat(short a, short b)
+{
+	return fix16_saturate((a << 6) / b);
+}
+
+static inline int fix19_13_mul(int a, int b)
+{
+	int high;
+
+	asm("mul %2, %0\n\tmov r30, %1" : "+r" (a), "=r" (high) : "r" (b) : "r30");
+	return ((unsigned int)a >> 13) | (high << 19);
+}
+
+// The product fits when the bits above it, from bit 12 of the high word, are all equal
+static inline int fix19_13_mul_sat(int a, int b)
+{
+	int high;
+
+	asm("mul %2, %0\n\tmov r30, %1" : "+r" (a), "=r" (high) : "r" (b) : "r30");
+
+	if ((unsigned int)((high >> 12) + 1) > 1)
+	{
+		return high < 0 ? FIX19_13_MIN : FIX19_13_MAX;
+	}
+
+	return ((unsigned int)a >> 13) | (high << 19);
+}
+
+// Goes through __divdi3, which divides by a 32-bit divisor in a few divu
+static inline int fix19_13_div(int a, int b)
+{
+	return ((long long)a << 13) / b;
+}
+
+static inline int fix19_13_div_sat(int a, int b)
+{
+	long long quotient = ((long long)a << 13) / b;
+
+	return quotient > FIX19_13_MAX ? FIX19_13_MAX : quotient < FIX19_13_MIN ? FIX19_13_MIN : (int)quotient;
+}
+
+#endif
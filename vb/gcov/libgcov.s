@@ -0,0 +1,184 @@
+/*
+ * Memory resident gcov runtime for the Virtual Boy
+ *
+ * Replaces the empty libgcov.a of the v810 toolchain, which was built without a C library
+ * and therefore cannot write .gcda files. Instead of writing files, the instrumented program
+ * keeps its counters in RAM and links every object's gcov_info into __gcov_list. The emulator
+ * walks that list after a play session and serializes the .gcda files on the host
+ * (see readGcov in web/shrooms-vb-core).
+ *
+ * The objects register themselves from their constructors, which vb/crt0/crt0.s runs before
+ * main(). Both -fprofile-arcs and -fprofile-generate are supported; the value profilers of the
+ * latter update the 64-bit counters in place as the libgcov of GCC 4.7 does.
+ *
+ * Build:
+ *     v810-as libgcov.s -o libgcov.o
+ *     v810-ar rcs libgcov.a libgcov.o
+ * and copy libgcov.a to <os>/gcc/lib/gcc/v810/4.7.4/.
+ */
+
+	.section .text
+
+/*
+ * void __gcov_init(struct gcov_info* info)
+ *
+ * Called by the constructor that the compiler emits for every instrumented object.
+ */
+	.global	___gcov_init
+___gcov_init:
+	ld.w	0[r6], r10			# info->version
+	cmp	0, r10
+	be	1f
+	movhi	hi(___gcov_list), r0, r11
+	movea	lo(___gcov_list), r11, r11
+	ld.w	0[r11], r10
+	st.w	r10, 4[r6]			# info->next = __gcov_list
+	st.w	r6, 0[r11]			# __gcov_list = info
+1:	jmp	[lp]
+
+/*
+ * Value profilers called by -fprofile-generate code. The 64-bit value arrives in r8:r9, as
+ * arguments of eight bytes are aligned to an even register, and any further arguments are
+ * on the stack.
+ */
+
+/* void __gcov_interval_profiler(gcov_type* counters, gcov_type value, int start, unsigned steps) */
+	.global	___gcov_interval_profiler
+___gcov_interval_profiler:
+	ld.w	0[sp], r10			# start
+	ld.w	4[sp], r11			# steps
+	mov	r10, r12
+	sar	31, r12
+	sub	r10, r8				# delta = value - start
+	setf	c, r13
+	sub	r12, r9
+	sub	r13, r9
+	cmp	0, r9
+	bge	1f
+	add	1, r11				# negative deltas count in counters[steps + 1]
+	br	2f
+1:	bne	2f				# deltas of steps or more count in counters[steps]
+	cmp	r11, r8
+	bl	3f
+2:	mov	r11, r8
+3:	shl	3, r8
+	add	r8, r6
+	br	.Lincrement
+
+/* void __gcov_pow2_profiler(gcov_type* counters, gcov_type value) */
+	.global	___gcov_pow2_profiler
+___gcov_pow2_profiler:
+	cmp	0, r8				# value & (value - 1)
+	setf	z, r12
+	mov	r9, r11
+	sub	r12, r11
+	mov	r8, r10
+	add	-1, r10
+	and	r8, r10
+	and	r9, r11
+	or	r11, r10
+	bne	.Lincrement			# counters[0]: not a power of two
+	add	8, r6				# counters[1]: a power of two or zero
+	br	.Lincrement
+
+/* void __gcov_indirect_call_profiler(gcov_type* counter, gcov_type value, void* cur_func, void* callee_func) */
+	.global	___gcov_indirect_call_profiler
+___gcov_indirect_call_profiler:
+	ld.w	0[sp], r10
+	ld.w	4[sp], r11
+	cmp	r10, r11
+	be	___gcov_one_value_profiler
+	jmp	[lp]
+
+/*
+ * void __gcov_one_value_profiler(gcov_type* counters, gcov_type value)
+ *
+ * counters[0] is the most common value, counters[1] its votes and counters[2] the calls.
+ */
+	.global	___gcov_one_value_profiler
+___gcov_one_value_profiler:
+	ld.w	0[r6], r10
+	ld.w	4[r6], r11
+	ld.w	8[r6], r12
+	ld.w	12[r6], r13
+	cmp	r8, r10
+	bne	1f
+	cmp	r9, r11
+	be	2f				# same value: one more vote
+1:	mov	r12, r14
+	or	r13, r14
+	bne	3f
+	st.w	r8, 0[r6]			# no votes left: take over the counter
+	st.w	r9, 4[r6]
+2:	add	1, r12
+	setf	c, r14
+	add	r14, r13
+	br	4f
+3:	cmp	0, r12				# another value: one vote less
+	setf	z, r14
+	sub	r14, r13
+	add	-1, r12
+4:	st.w	r12, 8[r6]
+	st.w	r13, 12[r6]
+	addi	16, r6, r6
+	br	.Lincrement
+
+/* void __gcov_average_profiler(gcov_type* counters, gcov_type value) */
+	.global	___gcov_average_profiler
+___gcov_average_profiler:
+	ld.w	0[r6], r10
+	ld.w	4[r6], r11
+	add	r8, r10				# counters[0] += value
+	setf	c, r12
+	add	r9, r11
+	add	r12, r11
+	st.w	r10, 0[r6]
+	st.w	r11, 4[r6]
+	add	8, r6				# counters[1]++
+
+/* Increments the 64-bit counter at r6 */
+.Lincrement:
+	ld.w	0[r6], r10
+	ld.w	4[r6], r11
+	add	1, r10
+	setf	c, r12
+	add	r12, r11
+	st.w	r10, 0[r6]
+	st.w	r11, 4[r6]
+	jmp	[lp]
+
+/* void __gcov_ior_profiler(gcov_type* counters, gcov_type value) */
+	.global	___gcov_ior_profiler
+___gcov_ior_profiler:
+	ld.w	0[r6], r10
+	ld.w	4[r6], r11
+	or	r8, r10
+	or	r9, r11
+	st.w	r10, 0[r6]
+	st.w	r11, 4[r6]
+	jmp	[lp]
+
+/*
+ * Counters are dumped by the emulator, so there is nothing to flush or merge on the target.
+ * The merge functions still have to exist because gcov_info refers to them to tell which
+ * counter kinds an object uses.
+ */
+	.global	___gcov_flush
+	.global	___gcov_merge_add
+	.global	___gcov_merge_delta
+	.global	___gcov_merge_ior
+	.global	___gcov_merge_single
+___gcov_flush:
+___gcov_merge_add:
+___gcov_merge_delta:
+___gcov_merge_ior:
+___gcov_merge_single:
+	jmp	[lp]
+
+	.section .bss
+	.align	2
+
+/* struct gcov_info* __gcov_list, read by the emulator */
+	.global	___gcov_list
+___gcov_list:
+	.space	4
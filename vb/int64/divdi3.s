@@ -0,0 +1,406 @@
+/*
+ * 64-bit division for the V810
+ *
+ * Replaces __udivdi3, __umoddi3, __divdi3 and __moddi3 from libgcc, whose generic C versions
+ * go through the same normalization and halfword steps whatever the size of the operands and
+ * build every product from four halfword multiplications. Here a dividend and a divisor of 32
+ * bits take a single divu, and a divisor of 32 bits, as fixed point code divides by, takes
+ * three divu when it is below 65536 and a normalized pair of halfword steps otherwise, with
+ * no divu for the high word and no shift when the highest bit of the divisor is set. Wider
+ * divisors take the same pair of steps and a single mulu for the product of the quotient with
+ * the rest of the divisor, since mulu leaves the high word in r30.
+ *
+ * Build:
+ *     v810-as divdi3.s -o divdi3.o
+ * and link divdi3.o with the game, before libgcc.
+ */
+
+	.section .text
+
+/* Negates the 64-bit value hi:lo, using tmp */
+	.macro	neg64 lo, hi, tmp
+	not	\lo, \lo
+	not	\hi, \hi
+	add	1, \lo
+	setf	c, \tmp
+	add	\tmp, \hi
+	.endm
+
+/*
+ * unsigned long long __udivdi3(unsigned long long dividend, unsigned long long divisor)
+ *
+ * Also the unsigned division of r7:r6 by r9:r8 behind the other functions, high word first,
+ * leaving the quotient in r11:r10 and the remainder in r13:r12. Uses r1, r6 to r17 and r30,
+ * like divu and mulu, and keeps r18 and r19 for the callers. The common cases fall through.
+ */
+	.global	___udivdi3
+___udivdi3:
+.Ludivmod:
+	cmp	0, r9
+	bne	.Lwide
+	cmp	0, r7
+	bne	.Lnarrow
+
+	# 32 by 32 bits
+	mov	r6, r10
+	divu	r8, r10
+	mov	r30, r12
+	mov	r0, r11
+	mov	r0, r13
+	jmp	[lp]
+
+	# 64 by 32 bits: the high word of the quotient first, when the divisor is not larger than
+	# the high word of the dividend, then the low word from the rest
+.Lnarrow:
+	mov	r0, r11
+	mov	r7, r12
+	cmp	r8, r7
+	bnl	.Lhigh
+1:	movhi	1, r0, r14
+	cmp	r14, r8
+	bl	.Lhalfwords
+	cmp	0, r8
+	blt	.Ltop
+
+	# Divisors of 65536 or more are shifted left until their highest bit is set, with the rest
+	# r12:r6, and the low word of the quotient is estimated a halfword at a time from the
+	# high halfword of the divisor and corrected, as udiv_qrnnd in libgcc does. The shift
+	# comes from the exponent of the divisor without its low byte converted to a float, which
+	# is exact, instead of a search for its highest bit, and is never 0 here
+	mov	r8, r15
+	shr	8, r15
+	cvt.ws	r15, r15
+	shr	23, r15				# 127 + 8 + log2 of the divisor - 16
+	movea	150, r0, r14
+	sub	r15, r14			# shift
+	addi	-118, r15, r15			# 32 - shift
+	mov	r8, r13
+	shl	r14, r13
+	mov	r6, r16
+	shr	r15, r16			# bits of r6 that move into r12
+	shl	r14, r12
+	or	r16, r12
+	mov	r6, r10
+	shl	r14, r10
+
+.Lsteps:
+	mov	r13, r15
+	shr	16, r15				# high halfword of the divisor
+	andi	0xFFFF, r13, r16		# low halfword
+
+	mov	r12, r17
+	divu	r15, r17			# high halfword of the quotient
+	mov	r30, r9
+	shl	16, r9
+	mov	r10, r8
+	shr	16, r8
+	or	r8, r9
+	mov	r17, r8
+	mulu	r16, r8
+	cmp	r8, r9
+	bl	.Lcorrect1
+2:	sub	r8, r9
+
+	andi	0xFFFF, r10, r7
+	mov	r9, r10
+	divu	r15, r10			# low halfword of the quotient
+	mov	r30, r9
+	shl	16, r9
+	or	r7, r9
+	mov	r10, r8
+	mulu	r16, r8
+	cmp	r8, r9
+	bl	.Lcorrect2
+3:	sub	r8, r9
+
+	shl	16, r17
+	or	r17, r10
+	mov	r9, r12
+	shr	r14, r12
+	mov	r0, r13
+	jmp	[lp]
+
+	# The estimates are at most two too large, which is rare enough to be handled out of line
+.Lcorrect1:
+	add	-1, r17
+	add	r13, r9
+	cmp	r13, r9
+	bc	2b
+	cmp	r8, r9
+	bnl	2b
+	add	-1, r17
+	add	r13, r9
+	br	2b
+
+.Lcorrect2:
+	add	-1, r10
+	add	r13, r9
+	cmp	r13, r9
+	bc	3b
+	cmp	r8, r9
+	bnl	3b
+	add	-1, r10
+	add	r13, r9
+	br	3b
+
+.Lhigh:
+	cmp	0, r8
+	blt	.Lonce
+	mov	r7, r11
+	divu	r8, r11
+	mov	r30, r12
+	br	1b
+
+	# A divisor with its highest bit set goes at most once into the high word of the dividend,
+	# and needs no shift before the halfword steps
+.Lonce:
+	sub	r8, r12
+	mov	1, r11
+.Ltop:
+	mov	r8, r13
+	mov	r6, r10
+	mov	r0, r14
+	br	.Lsteps
+
+	# Divisors below 65536 divide the rest by halfwords of the dividend with divu
+.Lhalfwords:
+	shl	16, r12
+	mov	r6, r15
+	shr	16, r15
+	or	r15, r12
+	divu	r8, r12
+	mov	r30, r13
+	shl	16, r13
+	andi	0xFFFF, r6, r15
+	or	r15, r13
+	divu	r8, r13
+	shl	16, r12
+	or	r13, r12
+	mov	r12, r10
+	mov	r30, r12
+	mov	r0, r13
+	jmp	[lp]
+
+	# Divisors of more than 32 bits leave a quotient of 32 bits at most. Both operands are
+	# shifted left until the highest bit of the divisor is set, the high word of the divisor
+	# gives the quotient with the same halfword steps, and the product of the quotient with the
+	# low word, from a single mulu, corrects it, as __udivmoddi4 in libgcc does
+.Lwide:
+	cmp	r9, r7
+	bl	.Lsmaller
+	mov	r9, r13
+	mov	r0, r14
+	mov	r13, r15
+	shr	16, r15
+	bne	4f
+	shl	16, r13
+	movea	16, r0, r14
+4:	mov	r13, r15
+	shr	24, r15
+	bne	5f
+	shl	8, r13
+	add	8, r14
+5:	mov	r13, r15
+	shr	28, r15
+	bne	6f
+	shl	4, r13
+	add	4, r14
+6:	mov	r13, r15
+	shr	30, r15
+	bne	7f
+	shl	2, r13
+	add	2, r14
+7:	cmp	0, r13
+	blt	8f
+	shl	1, r13
+	add	1, r14
+8:	cmp	0, r14
+	be	.Lnoshift
+
+	movea	32, r0, r15
+	sub	r14, r15
+	mov	r8, r16
+	shr	r15, r16
+	or	r16, r13			# divisor r13:r8
+	shl	r14, r8
+	mov	r7, r12
+	shr	r15, r12			# dividend r12:r7:r6
+	shl	r14, r7
+	mov	r6, r16
+	shr	r15, r16
+	or	r16, r7
+	shl	r14, r6
+
+	mov	r13, r15
+	shr	16, r15				# high halfword of the divisor
+	andi	0xFFFF, r13, r16		# next halfword
+
+	mov	r12, r17
+	divu	r15, r17			# high halfword of the quotient
+	mov	r30, r9
+	shl	16, r9
+	mov	r7, r11
+	shr	16, r11
+	or	r11, r9
+	mov	r17, r11
+	mulu	r16, r11
+	cmp	r11, r9
+	bl	.Lcorrect3
+9:	sub	r11, r9
+
+	mov	r9, r10
+	divu	r15, r10			# low halfword of the quotient
+	mov	r30, r9
+	shl	16, r9
+	andi	0xFFFF, r7, r11
+	or	r11, r9
+	mov	r10, r11
+	mulu	r16, r11
+	cmp	r11, r9
+	bl	.Lcorrect4
+10:	sub	r11, r9
+	shl	16, r17
+	or	r17, r10
+
+	# One less when the quotient times the whole divisor exceeds the dividend r9:r6
+	mov	r10, r16
+	mulu	r8, r16				# r30:r16
+	cmp	r30, r9
+	bl	.Lcorrect5
+	be	.Lcompare
+11:	sub	r16, r6
+	setf	c, r11
+	sub	r30, r9
+	sub	r11, r9
+	mov	r6, r12				# remainder r9:r6, shifted back
+	shr	r14, r12
+	movea	32, r0, r15
+	sub	r14, r15
+	mov	r9, r16
+	shl	r15, r16
+	or	r16, r12
+	mov	r9, r13
+	shr	r14, r13
+	mov	r0, r11
+	jmp	[lp]
+
+.Lcompare:
+	cmp	r16, r6
+	bnl	11b
+.Lcorrect5:
+	add	-1, r10
+	sub	r8, r16
+	setf	c, r11
+	sub	r13, r30
+	sub	r11, r30
+	br	11b
+
+.Lcorrect3:
+	add	-1, r17
+	add	r13, r9
+	cmp	r13, r9
+	bc	9b
+	cmp	r11, r9
+	bnl	9b
+	add	-1, r17
+	add	r13, r9
+	br	9b
+
+.Lcorrect4:
+	add	-1, r10
+	add	r13, r9
+	cmp	r13, r9
+	bc	10b
+	cmp	r11, r9
+	bnl	10b
+	add	-1, r10
+	add	r13, r9
+	br	10b
+
+	# A divisor with its highest bit set goes at most once into a dividend that is not smaller
+.Lnoshift:
+	cmp	r9, r7
+	bh	12f
+	cmp	r8, r6
+	bl	.Lsmaller
+12:	sub	r8, r6
+	setf	c, r15
+	sub	r9, r7
+	sub	r15, r7
+	mov	1, r10
+	mov	r0, r11
+	mov	r6, r12
+	mov	r7, r13
+	jmp	[lp]
+
+.Lsmaller:
+	mov	r0, r10
+	mov	r0, r11
+	mov	r6, r12
+	mov	r7, r13
+	jmp	[lp]
+
+/*
+ * unsigned long long __umoddi3(unsigned long long dividend, unsigned long long divisor)
+ */
+	.global	___umoddi3
+___umoddi3:
+	mov	lp, r19
+	jal	.Ludivmod
+	mov	r12, r10
+	mov	r13, r11
+	jmp	[r19]
+
+/*
+ * long long __divdi3(long long dividend, long long divisor)
+ *
+ * The quotient is negative when the signs of the operands differ. Negative operands are made
+ * positive out of line.
+ */
+	.global	___divdi3
+___divdi3:
+	mov	lp, r19
+	mov	r7, r18
+	xor	r9, r18
+	cmp	0, r7
+	blt	4f
+1:	cmp	0, r9
+	blt	5f
+2:	jal	.Ludivmod
+	cmp	0, r18
+	blt	6f
+3:	jmp	[r19]
+
+4:	neg64	r6, r7, r15
+	br	1b
+5:	neg64	r8, r9, r15
+	br	2b
+6:	neg64	r10, r11, r15
+	br	3b
+
+/*
+ * long long __moddi3(long long dividend, long long divisor)
+ *
+ * The remainder takes the sign of the dividend.
+ */
+	.global	___moddi3
+___moddi3:
+	mov	lp, r19
+	mov	r7, r18
+	cmp	0, r7
+	blt	4f
+1:	cmp	0, r9
+	blt	5f
+2:	jal	.Ludivmod
+	mov	r12, r10
+	mov	r13, r11
+	cmp	0, r18
+	blt	6f
+3:	jmp	[r19]
+
+4:	neg64	r6, r7, r15
+	br	1b
+5:	neg64	r8, r9, r15
+	br	2b
+6:	neg64	r10, r11, r15
+	br	3b
@@ -0,0 +1,365 @@
+/*
+ * memcpy, memmove, memset and memcmp for the V810
+ *
+ * The toolchain has no C library of its own to take these from, and the engine moves CHAR data,
+ * BGMAP segments, OBJ attributes and param tables with them every frame. Blocks are moved four
+ * words per iteration once both ends are aligned, with the unaligned head and tail moved by
+ * bytes and halfwords. A source and a destination that are not aligned the same way never
+ * reach that point, and copies of 16 bytes or more between them use the movbsu bit string
+ * instruction instead, which shifts the data as it moves it; it is slower than the word loop
+ * when both are aligned.
+ *
+ * Build:
+ *     v810-as memory.s -o memory.o
+ * and link memory.o with the game, before the libraries.
+ */
+
+	.section .text
+
+/*
+ * void* memcpy(void* destination, const void* source, size_t size)
+ */
+	.global	_memcpy
+_memcpy:
+	mov	r6, r10
+	mov	r6, r11
+	xor	r7, r11
+	andi	3, r11, r11
+	bne	.Lcopy_unaligned
+
+	# Both ends word aligned after the same head
+	andi	1, r6, r11
+	be	1f
+	cmp	0, r8
+	be	9f
+	ld.b	0[r7], r11
+	st.b	r11, 0[r6]
+	add	1, r7
+	add	1, r6
+	add	-1, r8
+1:	andi	2, r6, r11
+	be	2f
+	cmp	2, r8
+	bl	7f
+	ld.h	0[r7], r11
+	st.h	r11, 0[r6]
+	add	2, r7
+	add	2, r6
+	add	-2, r8
+2:	mov	r8, r12
+	shr	4, r12
+	be	4f
+3:	ld.w	0[r7], r13
+	ld.w	4[r7], r14
+	ld.w	8[r7], r15
+	ld.w	12[r7], r16
+	st.w	r13, 0[r6]
+	st.w	r14, 4[r6]
+	st.w	r15, 8[r6]
+	st.w	r16, 12[r6]
+	addi	16, r7, r7
+	addi	16, r6, r6
+	add	-1, r12
+	bne	3b
+	andi	15, r8, r8
+4:	cmp	4, r8
+	bl	6f
+5:	ld.w	0[r7], r11
+	st.w	r11, 0[r6]
+	add	4, r7
+	add	4, r6
+	add	-4, r8
+	cmp	4, r8
+	bnl	5b
+6:	cmp	2, r8
+	bl	7f
+	ld.h	0[r7], r11
+	st.h	r11, 0[r6]
+	add	2, r7
+	add	2, r6
+	add	-2, r8
+7:	cmp	0, r8
+	be	9f
+	ld.b	0[r7], r11
+	st.b	r11, 0[r6]
+9:	jmp	[lp]
+
+	# Ends aligned differently: bit strings from 16 bytes, otherwise halfwords when both ends
+	# are halfword aligned after the same head, or bytes
+.Lcopy_unaligned:
+	cmp	15, r8
+	bh	.Lcopy_bits
+	andi	1, r11, r11
+	bne	.Lcopy_bytes
+	andi	1, r6, r11
+	be	2f
+	cmp	0, r8
+	be	9b
+	ld.b	0[r7], r11
+	st.b	r11, 0[r6]
+	add	1, r7
+	add	1, r6
+	add	-1, r8
+2:	cmp	2, r8
+	bl	7b
+	ld.h	0[r7], r11
+	st.h	r11, 0[r6]
+	add	2, r7
+	add	2, r6
+	add	-2, r8
+	br	2b
+
+.Lcopy_bytes:
+	cmp	0, r8
+	be	9b
+1:	ld.b	0[r7], r11
+	st.b	r11, 0[r6]
+	add	1, r7
+	add	1, r6
+	add	-1, r8
+	bne	1b
+	jmp	[lp]
+
+	# Source in r30 and r27, destination in r29 and r26, as a word and a bit offset, and the
+	# length in bits in r28
+.Lcopy_bits:
+	addi	-20, sp, sp
+	st.w	r26, 0[sp]
+	st.w	r27, 4[sp]
+	st.w	r28, 8[sp]
+	st.w	r29, 12[sp]
+	st.w	r30, 16[sp]
+	andi	3, r7, r27
+	mov	r7, r30
+	xor	r27, r30
+	shl	3, r27
+	andi	3, r6, r26
+	mov	r6, r29
+	xor	r26, r29
+	shl	3, r26
+	mov	r8, r28
+	shl	3, r28
+	movbsu
+	ld.w	0[sp], r26
+	ld.w	4[sp], r27
+	ld.w	8[sp], r28
+	ld.w	12[sp], r29
+	ld.w	16[sp], r30
+	addi	20, sp, sp
+	jmp	[lp]
+
+/*
+ * void* memmove(void* destination, const void* source, size_t size)
+ *
+ * A destination below the source, or past its end, is copied upward as memcpy does, which
+ * movbsu does safely as well; otherwise the block is copied downward from its end.
+ */
+	.global	_memmove
+_memmove:
+	cmp	r7, r6
+	bnh	_memcpy
+	mov	r7, r11
+	add	r8, r11
+	cmp	r11, r6
+	bnl	_memcpy
+	mov	r6, r10
+	add	r8, r6
+	add	r8, r7
+	mov	r6, r11
+	xor	r7, r11
+	andi	3, r11, r11
+	bne	.Lmove_halfwords
+
+	# Both ends word aligned after the same tail
+	andi	1, r6, r11
+	be	1f
+	add	-1, r7
+	add	-1, r6
+	ld.b	0[r7], r11
+	st.b	r11, 0[r6]
+	add	-1, r8
+1:	andi	2, r6, r11
+	be	2f
+	cmp	2, r8
+	bl	7f
+	add	-2, r7
+	add	-2, r6
+	ld.h	0[r7], r11
+	st.h	r11, 0[r6]
+	add	-2, r8
+2:	mov	r8, r12
+	shr	4, r12
+	be	4f
+3:	addi	-16, r7, r7
+	addi	-16, r6, r6
+	ld.w	12[r7], r13
+	ld.w	8[r7], r14
+	ld.w	4[r7], r15
+	ld.w	0[r7], r16
+	st.w	r13, 12[r6]
+	st.w	r14, 8[r6]
+	st.w	r15, 4[r6]
+	st.w	r16, 0[r6]
+	add	-1, r12
+	bne	3b
+	andi	15, r8, r8
+4:	cmp	4, r8
+	bl	6f
+5:	add	-4, r7
+	add	-4, r6
+	ld.w	0[r7], r11
+	st.w	r11, 0[r6]
+	add	-4, r8
+	cmp	4, r8
+	bnl	5b
+6:	cmp	2, r8
+	bl	7f
+	add	-2, r7
+	add	-2, r6
+	ld.h	0[r7], r11
+	st.h	r11, 0[r6]
+	add	-2, r8
+7:	cmp	0, r8
+	be	9f
+	ld.b	-1[r7], r11
+	st.b	r11, -1[r6]
+9:	jmp	[lp]
+
+	# Both ends halfword aligned after the same tail
+.Lmove_halfwords:
+	andi	1, r11, r11
+	bne	.Lmove_bytes
+	andi	1, r6, r11
+	be	2f
+	add	-1, r7
+	add	-1, r6
+	ld.b	0[r7], r11
+	st.b	r11, 0[r6]
+	add	-1, r8
+2:	cmp	2, r8
+	bl	7b
+	add	-2, r7
+	add	-2, r6
+	ld.h	0[r7], r11
+	st.h	r11, 0[r6]
+	add	-2, r8
+	br	2b
+
+.Lmove_bytes:
+	add	-1, r7
+	add	-1, r6
+	ld.b	0[r7], r11
+	st.b	r11, 0[r6]
+	add	-1, r8
+	bne	.Lmove_bytes
+	jmp	[lp]
+
+/*
+ * void* memset(void* destination, int value, size_t size)
+ *
+ * The bit string instructions only combine the destination with a source, so the body is
+ * written with stores, eight words per iteration.
+ */
+	.global	_memset
+_memset:
+	mov	r6, r10
+	andi	0xFF, r7, r7
+	mov	r7, r11
+	shl	8, r11
+	or	r11, r7
+	mov	r7, r11
+	shl	16, r11
+	or	r11, r7
+	andi	1, r6, r11
+	be	1f
+	cmp	0, r8
+	be	9f
+	st.b	r7, 0[r6]
+	add	1, r6
+	add	-1, r8
+1:	andi	2, r6, r11
+	be	2f
+	cmp	2, r8
+	bl	7f
+	st.h	r7, 0[r6]
+	add	2, r6
+	add	-2, r8
+2:	mov	r8, r12
+	shr	5, r12
+	be	4f
+3:	st.w	r7, 0[r6]
+	st.w	r7, 4[r6]
+	st.w	r7, 8[r6]
+	st.w	r7, 12[r6]
+	st.w	r7, 16[r6]
+	st.w	r7, 20[r6]
+	st.w	r7, 24[r6]
+	st.w	r7, 28[r6]
+	addi	32, r6, r6
+	add	-1, r12
+	bne	3b
+	andi	31, r8, r8
+4:	cmp	4, r8
+	bl	6f
+5:	st.w	r7, 0[r6]
+	add	4, r6
+	add	-4, r8
+	cmp	4, r8
+	bnl	5b
+6:	cmp	2, r8
+	bl	7f
+	st.h	r7, 0[r6]
+	add	2, r6
+	add	-2, r8
+7:	cmp	0, r8
+	be	9f
+	st.b	r7, 0[r6]
+9:	jmp	[lp]
+
+/*
+ * int memcmp(const void* first, const void* second, size_t size)
+ *
+ * Words are compared while both are aligned and equal; the word that differs is compared again
+ * a byte at a time, since the lowest address holds the lowest byte. in.b reads bytes without
+ * extending their sign.
+ */
+	.global	_memcmp
+_memcmp:
+	mov	r6, r11
+	xor	r7, r11
+	andi	3, r11, r11
+	bne	4f
+1:	andi	3, r6, r11
+	be	2f
+	cmp	0, r8
+	be	8f
+	in.b	0[r6], r10
+	in.b	0[r7], r11
+	sub	r11, r10
+	bne	9f
+	add	1, r6
+	add	1, r7
+	add	-1, r8
+	br	1b
+2:	cmp	4, r8
+	bl	4f
+	ld.w	0[r6], r12
+	ld.w	0[r7], r13
+	cmp	r13, r12
+	bne	4f
+	add	4, r6
+	add	4, r7
+	add	-4, r8
+	br	2b
+4:	cmp	0, r8
+	be	8f
+5:	in.b	0[r6], r10
+	in.b	0[r7], r11
+	sub	r11, r10
+	bne	9f
+	add	1, r6
+	add	1, r7
+	add	-1, r8
+	bne	5b
+8:	mov	r0, r10
+9:	jmp	[lp]
@@ -0,0 +1,24 @@
+#ifndef SEMIHOST_H_
+#define SEMIHOST_H_
+
+// Requests to shrooms-vb-core, implemented in semihost.s. _open, _close, _read, _write and
+// _lseek take the same arguments and flags as their newlib counterparts and work on the files
+// the page gave to sim.setSemihosting(); writes to files 1 and 2 go to stdout and stderr. All
+// of them return -1 when the program is not running in the emulator.
+
+int _open(const char* path, int flags, int mode);
+int _close(int file);
+int _read(int file, void* buffer, int length);
+int _write(int file, const void* buffer, int length);
+int _lseek(int file, int offset, int whence);
+
+// Clocks emulated so far, to within 1000 clocks
+unsigned long long semihost_clock(void);
+
+// Writes a block of memory to a file in one request
+int semihost_dump(const char* name, const void* address, unsigned int length);
+
+// Gives the status to sim.readSemihosting() and halts
+void semihost_exit(int status);
+
+#endif
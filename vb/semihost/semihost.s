@@ -0,0 +1,166 @@
+/*
+ * Semihosting for programs that run in shrooms-vb-core
+ *
+ * Replaces the system calls of libsim, which print to an I/O port of the GDB simulator, and of
+ * libnosys, which fail, with requests to the emulator through a mailbox in RAM: the arguments
+ * and then the command are stored in _semihost, and the program waits for the emulator to clear
+ * the command and leave the result. The emulator polls the mailbox every 1000 clocks once
+ * sim.setSemihosting() is given its address, reads and writes the files the page gave it, and
+ * also answers with the clocks emulated so far and writes blocks of memory to files at once.
+ *
+ * The emulator announces itself in the first word of the mailbox whenever it polls. Without it,
+ * on hardware, the first request gives up after a few thousand loads and the following ones
+ * fail at once, returning -1. Requests must not be made from interrupt handlers.
+ *
+ * Build:
+ *     v810-as semihost.s -o semihost.o
+ * and link semihost.o with the game, before libsim or libnosys.
+ */
+
+	# Mailbox, as in Constants.js
+	.set	HOST, 0
+	.set	COMMAND, 4
+	.set	ARGS, 8
+	.set	RESULT, 20
+	.set	MAILBOX_SIZE, 28
+
+	.set	MAGIC, 0x54534F48
+	.set	WAIT, 8192
+
+	.set	OPEN, 1
+	.set	CLOSE, 2
+	.set	READ, 3
+	.set	WRITE, 4
+	.set	LSEEK, 5
+	.set	CLOCK, 6
+	.set	DUMP, 7
+	.set	EXIT, 8
+
+	.section .text
+
+/*
+ * int _open(const char* path, int flags, int mode)
+ * int _close(int file)
+ * int _read(int file, void* buffer, int length)
+ * int _write(int file, const void* buffer, int length)
+ * int _lseek(int file, int offset, int whence)
+ *
+ * Files 0 to 2 are always open; what is written to 1 and 2 goes to the files stdout and stderr.
+ */
+	.global	__open
+__open:
+	mov	OPEN, r10
+	br	.Lrequest
+
+	.global	__close
+__close:
+	mov	CLOSE, r10
+	br	.Lrequest
+
+	.global	__read
+__read:
+	mov	READ, r10
+	br	.Lrequest
+
+	.global	__write
+__write:
+	mov	WRITE, r10
+	br	.Lrequest
+
+	.global	__lseek
+__lseek:
+	mov	LSEEK, r10
+	br	.Lrequest
+
+/*
+ * unsigned long long semihost_clock(void)
+ *
+ * Clocks emulated since the mailbox was given to the emulator, counted up to the poll that
+ * answers, so two readings are within 1000 clocks of the time between them.
+ */
+	.global	_semihost_clock
+_semihost_clock:
+	mov	CLOCK, r10
+	br	.Lrequest
+
+/*
+ * int semihost_dump(const char* name, const void* address, unsigned int length)
+ *
+ * Writes a block of memory to a file of its own in one request.
+ */
+	.global	_semihost_dump
+_semihost_dump:
+	mov	DUMP, r10
+	br	.Lrequest
+
+/*
+ * void semihost_exit(int status)
+ *
+ * Gives the status to the emulator and halts for good.
+ */
+	.global	_semihost_exit
+_semihost_exit:
+	mov	EXIT, r10
+	jal	.Lrequest
+1:	halt
+	br	1b
+
+	# Command in r10 and arguments in r6 to r8, result in r11:r10
+.Lrequest:
+	movhi	hi(_semihost), r0, r11
+	movea	lo(_semihost), r11, r11
+	movhi	hi(MAGIC), r0, r12
+	movea	lo(MAGIC), r12, r12
+	ld.w	HOST[r11], r13
+	cmp	r12, r13
+	be	3f
+	cmp	-1, r13
+	be	2f
+	movea	WAIT, r0, r14
+1:	ld.w	HOST[r11], r13
+	cmp	r12, r13
+	be	3f
+	add	-1, r14
+	bne	1b
+	mov	-1, r13
+	st.w	r13, HOST[r11]
+2:	mov	-1, r10
+	mov	-1, r11
+	jmp	[lp]
+3:	st.w	r6, ARGS[r11]
+	st.w	r7, ARGS + 4[r11]
+	st.w	r8, ARGS + 8[r11]
+	st.w	r10, COMMAND[r11]
+4:	ld.w	COMMAND[r11], r13
+	cmp	0, r13
+	bne	4b
+	ld.w	RESULT[r11], r10
+	ld.w	RESULT + 4[r11], r11
+	jmp	[lp]
+
+/*
+ * int _fstat(int file, struct stat* status)
+ * int isatty(int file)
+ *
+ * As in libsim, every file is a character device, and files 0 to 2 are terminals.
+ */
+	.global	__fstat
+__fstat:
+	movea	0x2000, r0, r10			# S_IFCHR
+	st.w	r10, 4[r7]
+	mov	r0, r10
+	jmp	[lp]
+
+	.global	_isatty
+_isatty:
+	mov	r0, r10
+	cmp	3, r6
+	setf	c, r10
+	jmp	[lp]
+
+	.section .bss
+	.align	2
+
+	.global	_semihost
+_semihost:
+	.space	MAILBOX_SIZE
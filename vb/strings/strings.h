@@ -0,0 +1,10 @@
+#ifndef STRINGS_H_
+#define STRINGS_H_
+
+// Places a global string, like the name of a class, in .strings as a mergeable string, so that
+// the linker keeps a single copy of equal strings and stores a string that ends another one
+// inside it. The flags are appended to the section directive that gcc writes, whose own flags
+// are commented out by the '#'.
+#define MERGED_STRING		__attribute__((section(".strings,\"aMS\",@progbits,1 #")))
+
+#endif
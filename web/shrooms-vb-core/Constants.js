@@ -71,6 +71,54 @@ export default {
         Z         : 1
     },
 
+    // gcov data files (GCC 4.7)
+    gcov: {
+
+        // Counter kinds
+        ARCS    : 0,
+        COUNTERS: 8,
+
+        // Record tags
+        DATA_MAGIC         : 0x67636461,
+        TAG_COUNTER_BASE   : 0x01A10000,
+        TAG_FUNCTION       : 0x01000000,
+        TAG_PROGRAM_SUMMARY: 0xA3000000
+    },
+
+    // Semihosting mailbox (vb/semihost)
+    semihost: {
+
+        // Mailbox offsets
+        HOST   :  0,
+        COMMAND:  4,
+        ARGS   :  8,
+        RESULT : 20,
+
+        // Host presence and polling interval in clocks
+        MAGIC: 0x54534F48,
+        SLICE: 1000,
+
+        // Longest transfer, the size of the address space, which repeats above
+        SPACE: 0x08000000,
+
+        // Commands
+        OPEN : 1,
+        CLOSE: 2,
+        READ : 3,
+        WRITE: 4,
+        LSEEK: 5,
+        CLOCK: 6,
+        DUMP : 7,
+        EXIT : 8,
+
+        // Open flags, as in newlib
+        O_WRONLY : 0x0001,
+        O_ACCMODE: 0x0003,
+        O_APPEND : 0x0008,
+        O_CREAT  : 0x0200,
+        O_TRUNC  : 0x0400
+    },
+
     // Web interface
     web: {
 
@@ -80,9 +80,12 @@ new class Core {
         // Process all sims
         for (let x = 0; x < message.count; x++) {
             let sim = {
-                canvas  : null,
-                keys    : Constants.VB.SGN,
-                pointer : sims[x] = this.CreateSim()
+                canvas     : null,
+                keys       : Constants.VB.SGN,
+                calls      : null,
+                pointer    : sims[x] = this.CreateSim(),
+                sampling   : null,
+                semihosting: null
             };
             this.sims.set(sim.pointer, sim);
 
@@ -226,17 +229,13 @@ new class Core {
         while (!broke && this.clocked.clocks[0] != 0) {
 
             // Process simulations until a suspension
-            this.Emulate(
-                this.clocked.pointers.pointer,
-                message.sims.length,
-                this.clocked.clocks.pointer
-            );
+            this.#emulate(this.clocked);
 
             // Monitor break conditions
             for (let x = 0; x < message.sims.length; x++) {
                 let sim    = this.clocked.sims[x];
                 sim.breaks = this.GetBreaks(sim.pointer);
-                if (breaks & Constants.web.BREAK_POINT)
+                if (sim.breaks & Constants.web.BREAK_POINT)
                     broke = true;
             }
 
@@ -293,6 +292,175 @@ new class Core {
         }, [ output.buffer ]);
     }
 
+    // Serialize the gcov counters of a program into .gcda files
+    readGcov(message) {
+        let sim   = message.sim;
+        let files = [];
+        let infos = [];
+
+        // Working variables
+        let summary = { checksum: 0, num: 0, sumAll: 0n, runMax: 0n };
+        let word    = address=>this.vbRead(sim, address, Constants.VB.S32)>>>0;
+        let crc     = (crc, value)=>{
+            for (let x = 0; x < 32; x++, value <<= 1) {
+                let feedback = (value ^ crc) & 0x80000000 ? 0x04C11DB7 : 0;
+                crc = (crc << 1 ^ feedback) >>> 0;
+            }
+            return crc;
+        };
+
+        // Walk the list of registered objects built by __gcov_init
+        for (
+            let info = word(message.list);
+            info != 0 && infos.length < 0x10000;
+            info = word(info + 4)
+        ) {
+            let obj = {
+                functions: [],
+                kinds    : [],
+                filename : this.#readString(sim, word(info + 12)),
+                stamp    : word(info + 8),
+                version  : word(info)
+            };
+            for (let x = 0; x < Constants.gcov.COUNTERS; x++) {
+                if (word(info + 16 + x * 4) != 0)
+                    obj.kinds.push(x);
+            }
+            let count     = word(info + 16 + Constants.gcov.COUNTERS * 4);
+            let functions = word(info + 20 + Constants.gcov.COUNTERS * 4);
+
+            // Whole program summary over the arc counters
+            summary.checksum = crc(summary.checksum, obj.stamp);
+            for (let x = 0; x < count; x++) {
+                let fn = word(functions + x * 4);
+                if (fn != 0 && word(fn) != info)
+                    fn = 0; // Emitted by another object (COMDAT)
+                summary.checksum = crc(summary.checksum, fn ? word(fn + 12) : 0);
+                summary.checksum = crc(summary.checksum, fn ? word(fn +  8) : 0);
+                if (fn == 0) {
+                    obj.functions.push(null);
+                    continue;
+                }
+
+                // Read the counters of each kind the object uses
+                let func = {
+                    cfgChecksum   : word(fn + 12),
+                    ident         : word(fn +  4),
+                    linenoChecksum: word(fn +  8),
+                    counters      : []
+                };
+                for (let y = 0; y < obj.kinds.length; y++) {
+                    let num    = word(fn + 16 + y * 8);
+                    let values = word(fn + 20 + y * 8);
+                    let ctrs   = new Uint32Array(num * 2);
+                    for (let z = 0; z < ctrs.length; z++)
+                        ctrs[z] = word(values + z * 4);
+                    func.counters.push(ctrs);
+                    if (obj.kinds[y] != Constants.gcov.ARCS)
+                        continue;
+                    summary.num     += num;
+                    summary.checksum = crc(summary.checksum, num);
+                    for (let z = 0; z < num; z++) {
+                        let value = BigInt(ctrs[z*2]) | BigInt(ctrs[z*2+1]) << 32n;
+                        summary.sumAll += value;
+                        if (value > summary.runMax)
+                            summary.runMax = value;
+                    }
+                }
+                obj.functions.push(func);
+            }
+            infos.push(obj);
+        }
+
+        // Produce one .gcda file per object
+        for (let obj of infos) {
+            let data = [ Constants.gcov.DATA_MAGIC, obj.version, obj.stamp ];
+
+            // Program summary
+            data.push(Constants.gcov.TAG_PROGRAM_SUMMARY, 9,
+                summary.checksum, summary.num, 1,
+                ... [ summary.sumAll, summary.runMax, summary.runMax ]
+                .flatMap(v=>[ Number(v & 0xFFFFFFFFn), Number(v >> 32n) ])
+            );
+
+            // Function records
+            for (let func of obj.functions) {
+                if (func == null) {
+                    data.push(Constants.gcov.TAG_FUNCTION, 0);
+                    continue;
+                }
+                data.push(Constants.gcov.TAG_FUNCTION, 3, func.ident,
+                    func.linenoChecksum, func.cfgChecksum);
+                for (let y = 0; y < obj.kinds.length; y++) {
+                    let ctrs = func.counters[y];
+                    data.push(Constants.gcov.TAG_COUNTER_BASE +
+                        (obj.kinds[y] << 17) >>> 0, ctrs.length, ... ctrs);
+                }
+            }
+            data.push(0);
+
+            let buffer = Uint32Array.from(data).buffer;
+            files.push({ filename: obj.filename, data: buffer });
+        }
+
+        this.dom.postMessage({
+            files   : files,
+            promised: true
+        }, files.map(f=>f.data));
+    }
+
+    // Retrieve and clear the calls counted in a sim
+    readCalls(message) {
+        let sim     = this.sims.get(message.sim);
+        let calls   = sim.calls ?? new Map();
+        let arcs    = [];
+        for (let [ caller, targets ] of calls)
+            for (let [ callee, count ] of targets)
+                arcs.push([ caller, callee, count ]);
+        let callers = Uint32Array.from(arcs, a=>a[0]);
+        let callees = Uint32Array.from(arcs, a=>a[1]);
+        let counts  = Uint32Array.from(arcs, a=>a[2]);
+        calls.clear();
+        this.dom.postMessage({
+            callers : callers.buffer,
+            callees : callees.buffer,
+            counts  : counts.buffer,
+            promised: true
+        }, [ callers.buffer, callees.buffer, counts.buffer ]);
+    }
+
+    // Retrieve and clear the program counter samples of a sim
+    readSamples(message) {
+        let sim       = this.sims.get(message.sim);
+        let samples   = sim.sampling?.samples ?? new Map();
+        let addresses = Uint32Array.from(samples.keys());
+        let counts    = Uint32Array.from(samples.values());
+        samples.clear();
+        this.dom.postMessage({
+            addresses: addresses.buffer,
+            counts   : counts.buffer,
+            promised : true
+        }, [ addresses.buffer, counts.buffer ]);
+    }
+
+    // Retrieve the files written through semihosting and the exit status
+    readSemihosting(message) {
+        let sim   = this.sims.get(message.sim);
+        let host  = sim.semihosting;
+        let files = [];
+        for (let [ filename, file ] of host?.files ?? []) {
+            if (!file.written)
+                continue;
+            let data = file.data.slice(0, file.size).buffer;
+            files.push({ filename: filename, data: data });
+        }
+        this.dom.postMessage({
+            files   : files,
+            promised: true,
+            status  : host?.status ?? null
+        }, files.map(f=>f.data));
+    }
+
     // Reset simulation state
     reset(message) {
         this.vbReset(message.sim);
@@ -305,6 +473,15 @@ new class Core {
         this.dom.postMessage({ promised: true });
     }
 
+    // Turn the counting of calls in a sim on or off
+    setCallCounting(message) {
+        let sim = this.sims.get(message.sim);
+        if (!message.enabled)
+            sim.calls = null;
+        else sim.calls ??= new Map();
+        this.dom.postMessage({ promised: true });
+    }
+
     // Specify the OffscreenCanvas that goes with a sim
     setCanvas(message) {
         let sim = this.sims.get(message.sim);
@@ -358,6 +535,40 @@ new class Core {
         });
     }
 
+    // Specify the program counter sampling interval of a sim
+    setSampling(message) {
+        let sim = this.sims.get(message.sim);
+        if (message.interval == 0)
+            sim.sampling = null;
+        else sim.sampling = {
+            interval: message.interval,
+            next    : message.interval,
+            samples : sim.sampling?.samples ?? new Map()
+        };
+        this.dom.postMessage({ promised: true });
+    }
+
+    // Serve the semihosting mailbox of a program (address 0 = off)
+    setSemihosting(message) {
+        let sim    = this.sims.get(message.sim);
+        let output = Constants.semihost.O_WRONLY | Constants.semihost.O_APPEND;
+        if (message.address == 0)
+            sim.semihosting = null;
+        else sim.semihosting = {
+            address: message.address,
+            clocks : 0,
+            files  : new Map(message.files.map(f=>[ f.filename, {
+                data   : new Uint8Array(f.data),
+                size   : f.data.byteLength,
+                written: false
+            } ])),
+            handles: [ 0, output, output ].map(f=>
+                ({ file: null, position: 0, flags: f })),
+            status : null
+        };
+        this.dom.postMessage({ promised: true });
+    }
+
     // Specify audio volume
     setVolume(message) {
         this.SetVolume(message.sim, message.volume);
@@ -431,11 +642,7 @@ new class Core {
             // Process all clocks
             this.automatic.clocks[0] = 400000; // 0.02s
             while (this.automatic.clocks[0] != 0) {
-                this.Emulate(
-                    this.automatic.pointers.pointer,
-                    this.automatic.sims.length,
-                    this.automatic.clocks.pointer
-                );
+                this.#emulate(this.automatic);
 
                 // Too many buffers left to output video
                 if (this.audio.buffers.length > 2)
@@ -470,6 +677,107 @@ new class Core {
 
     }
 
+    // Emulate one clock at a time, counting the calls made by jal and jmp
+    #countCalls(state, counted, slice) {
+        let count   = state.pointers.length;
+        let sims    = state.sims.slice(0, count);
+        let elapsed = 0;
+        let pcs     = counted.map(s=>this.vbGetProgramCounter(s.pointer) >>> 0);
+
+        while (elapsed < slice) {
+            state.clocks[0] = 1;
+            this.Emulate(state.pointers.pointer, count, state.clocks.pointer);
+            elapsed += 1 - state.clocks[0];
+
+            // Check the instructions that completed
+            for (let x = 0; x < counted.length; x++) {
+                let sim  = counted[x];
+                let from = pcs[x];
+                let to   = pcs[x] =
+                    this.vbGetProgramCounter(sim.pointer) >>> 0;
+                if (to == from)
+                    continue;
+                let bits   = this.vbRead(sim.pointer, from, Constants.VB.U16);
+                let opcode = bits >> 10 & 0x3F;
+
+                // jal disp26, except to the next instruction to get the pc
+                if (opcode == 0x2B) {
+                    let disp = (bits & 0x3FF) << 16 |
+                        this.vbRead(sim.pointer, from + 2, Constants.VB.U16);
+                    if (to != (from + (disp << 6 >> 6) >>> 0) ||
+                        to == from + 4)
+                        continue;
+                }
+
+                // jmp [reg1] with lp set up to return after it, as indirect
+                // calls do. Returns and jump tables leave lp elsewhere
+                else if (opcode != 0x06 ||
+                    this.vbGetProgramRegister(sim.pointer, 31) >>> 0 !=
+                        from + 2 >>> 0 ||
+                    to != this.vbGetProgramRegister(sim.pointer, bits & 0x1F)
+                        >>> 0)
+                    continue;
+
+                let callees = sim.calls.get(from);
+                if (callees === undefined)
+                    sim.calls.set(from, callees = new Map());
+                callees.set(to, (callees.get(to) ?? 0) + 1);
+            }
+
+            // Stop at frames and break points as Emulate() would
+            if (sims.some(s=>this.GetBreaks(s.pointer) != 0))
+                break;
+        }
+
+        return elapsed;
+    }
+
+    // Process simulations, stopping to sample program counters and to serve
+    // semihosting requests if needed
+    #emulate(state) {
+        let count   = state.pointers.length;
+        let sims    = state.sims.slice(0, count);
+        let sampled = sims.filter(s=>s.sampling != null);
+        let counted = sims.filter(s=>s.calls != null);
+        let hosted  = sims.filter(s=>s.semihosting != null);
+
+        // No profiling or semihosting is taking place
+        if (sampled.length == 0 && counted.length == 0 && hosted.length == 0) {
+            this.Emulate(state.pointers.pointer, count, state.clocks.pointer);
+            return;
+        }
+
+        // Emulate up to the next sample or semihosting poll
+        let clocks = state.clocks[0];
+        let slice  = Math.min(clocks, ... sampled.map(s=>s.sampling.next),
+            ... hosted.map(s=>Constants.semihost.SLICE));
+        let elapsed;
+        if (counted.length != 0)
+            elapsed = this.#countCalls(state, counted, slice);
+        else {
+            state.clocks[0] = slice;
+            this.Emulate(state.pointers.pointer, count, state.clocks.pointer);
+            elapsed = slice - state.clocks[0];
+        }
+        state.clocks[0] = clocks - elapsed;
+
+        // Record program counters
+        for (let sim of sampled) {
+            let sampling = sim.sampling;
+            sampling.next -= elapsed;
+            if (sampling.next != 0)
+                continue;
+            let pc = this.vbGetProgramCounter(sim.pointer) >>> 0;
+            sampling.samples.set(pc, (sampling.samples.get(pc) ?? 0) + 1);
+            sampling.next = sampling.interval;
+        }
+
+        // Serve semihosting requests
+        for (let sim of hosted)
+            this.#semihost(sim, elapsed);
+
+    }
+
     // Delete an allocated buffer in WebAssembly memory
     #free(buffer) {
         this.mallocs.delete(buffer.pointer);
@@ -505,6 +813,14 @@ new class Core {
         return buffer;
     }
 
+    // Read a C string from simulation memory
+    #readString(sim, address) {
+        let chars = [];
+        for (let c; (c = this.vbRead(sim, address++, Constants.VB.U8)) != 0;)
+            chars.push(c);
+        return String.fromCodePoint(... chars);
+    }
+
     // Resize a previously allocated buffer in WebAssembly memory
     #realloc(prev, count) {
         this.mallocs.delete(prev.pointer);
@@ -522,6 +838,156 @@ new class Core {
         return buffer;
     }
 
+    // Serve the request waiting in the semihosting mailbox of a sim
+    #semihost(sim, elapsed) {
+        let host    = sim.semihosting;
+        let pointer = sim.pointer;
+        let K       = Constants.semihost;
+        let word    = offset=>
+            this.vbRead(pointer, host.address + offset, Constants.VB.S32);
+        host.clocks += elapsed;
+
+        // Announce the host, which the program waits for on its first request
+        this.vbWrite(pointer, host.address + K.HOST, Constants.VB.S32, K.MAGIC);
+        let command = word(K.COMMAND);
+        if (command == 0)
+            return;
+        let args    = [ word(K.ARGS), word(K.ARGS + 4), word(K.ARGS + 8) ];
+        let handle  = host.handles[args[0]] ?? null;
+        let result  = -1;
+
+        // Working variables
+        let grow = (file, size)=>{
+            if (size > file.data.length) {
+                let data = new Uint8Array(Math.max(size, file.data.length * 2));
+                data.set(file.data.subarray(0, file.size));
+                file.data = data;
+            }
+            file.size = Math.max(file.size, size);
+        };
+        let output = name=>{
+            let file = host.files.get(name);
+            if (file === undefined) {
+                host.files.set(name, file =
+                    { data: new Uint8Array(256), size: 0, written: true });
+            }
+            return file;
+        };
+
+        switch (command) {
+
+            // open(path, flags, mode)
+            case K.OPEN: {
+                let name = this.#readString(pointer, args[0] >>> 0);
+                let file = host.files.get(name);
+                if (file === undefined && !(args[1] & K.O_CREAT))
+                    break;
+                file = file ?? output(name);
+                if (args[1] & K.O_TRUNC) {
+                    file.size    = 0;
+                    file.written = true;
+                }
+                result = host.handles.indexOf(null, 3);
+                if (result == -1)
+                    result = host.handles.length;
+                host.handles[result] =
+                    { file: file, position: 0, flags: args[1] };
+                break;
+            }
+
+            // close(file)
+            case K.CLOSE:
+                if (handle === null || args[0] < 3)
+                    break;
+                host.handles[args[0]] = null;
+                result = 0;
+                break;
+
+            // read(file, buffer, length)
+            case K.READ: {
+                if (handle === null)
+                    break;
+                let file  = handle.file;
+                let count = file === null ? 0 :
+                    Math.max(0, Math.min(args[2], file.size - handle.position));
+                for (let x = 0; x < count; x++) {
+                    this.vbWrite(pointer, args[1] + x, Constants.VB.U8,
+                        file.data[handle.position + x]);
+                }
+                handle.position += count;
+                result = count;
+                break;
+            }
+
+            // write(file, buffer, length), with 1 and 2 as stdout and stderr
+            case K.WRITE: {
+                if (handle === null || (handle.flags & K.O_ACCMODE) == 0 ||
+                    args[2] < 0)
+                    break;
+                let count = Math.min(args[2], K.SPACE);
+                let file  = handle.file ??=
+                    output(args[0] == 2 ? "stderr" : "stdout");
+                if (handle.flags & K.O_APPEND)
+                    handle.position = file.size;
+                grow(file, handle.position + count);
+                for (let x = 0; x < count; x++) {
+                    file.data[handle.position + x] = this.vbRead(pointer,
+                        (args[1] + x) >>> 0, Constants.VB.U8);
+                }
+                file.written     = true;
+                handle.position += count;
+                result           = count;
+                break;
+            }
+
+            // lseek(file, offset, whence)
+            case K.LSEEK: {
+                if (handle === null || handle.file === null)
+                    break;
+                let position = args[1] + [ 0, handle.position,
+                    handle.file.size ][args[2]];
+                if (!(position >= 0))
+                    break;
+                result = handle.position = position;
+                break;
+            }
+
+            // Clocks emulated so far, in 64 bits
+            case K.CLOCK:
+                result = host.clocks % 0x100000000;
+                this.vbWrite(pointer, host.address + K.RESULT + 4,
+                    Constants.VB.S32, Math.floor(host.clocks / 0x100000000));
+                break;
+
+            // dump(name, address, length): write memory to a file at once
+            case K.DUMP: {
+                if (args[2] < 0)
+                    break;
+                let count = Math.min(args[2], K.SPACE);
+                let file  = output(this.#readString(pointer, args[0] >>> 0));
+                file.size    = 0;
+                file.written = true;
+                grow(file, count);
+                for (let x = 0; x < count; x++) {
+                    file.data[x] = this.vbRead(pointer, (args[1] + x) >>> 0,
+                        Constants.VB.U8);
+                }
+                result = count;
+                break;
+            }
+
+            // exit(status)
+            case K.EXIT:
+                host.status = args[0];
+                result      = 0;
+                break;
+        }
+
+        // Reply and free the mailbox
+        this.vbWrite(pointer, host.address + K.RESULT, Constants.VB.S32, result);
+        this.vbWrite(pointer, host.address + K.COMMAND, Constants.VB.S32, 0);
+    }
+
     // Compute anaglyph color values
     #setAnaglyph(sim, left, right) {
 
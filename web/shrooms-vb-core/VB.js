@@ -436,6 +436,71 @@ class Sim extends HTMLElement {
             response.lines.map(l=>new DasmLine(GUARD, l));
     }
 
+    // Produce .gcda files from the counters of a -fprofile-arcs program
+    async readGcov(list) {
+
+        // Error checking
+        if (!Number.isSafeInteger(list) || list < 0 || list > 0xFFFFFFFF)
+            throw new RangeError("List must conform to Uint32.");
+
+        // Request the files from the core
+        let response = await this.#core.toCore({
+            command : "readGcov",
+            promised: true,
+            sim     : this.#pointer,
+            list    : list
+        });
+        return response.files.map(f=>({
+            filename: f.filename,
+            data    : new Uint8Array(f.data)
+        }));
+    }
+
+    // Retrieve and clear the calls counted so far
+    async readCalls() {
+        let response = await this.#core.toCore({
+            command : "readCalls",
+            promised: true,
+            sim     : this.#pointer
+        });
+        let callers = new Uint32Array(response.callers);
+        let callees = new Uint32Array(response.callees);
+        let counts  = new Uint32Array(response.counts);
+        return Array.from(callers, (c, x)=>({
+            caller: c,
+            callee: callees[x],
+            count : counts[x]
+        }));
+    }
+
+    // Retrieve and clear the program counter samples taken so far
+    async readSamples() {
+        let response = await this.#core.toCore({
+            command : "readSamples",
+            promised: true,
+            sim     : this.#pointer
+        });
+        let addresses = new Uint32Array(response.addresses);
+        let counts    = new Uint32Array(response.counts);
+        return new Map(Array.from(addresses, (a, x)=>[ a, counts[x] ]));
+    }
+
+    // Retrieve the files written through semihosting and the exit status
+    async readSemihosting() {
+        let response = await this.#core.toCore({
+            command : "readSemihosting",
+            promised: true,
+            sim     : this.#pointer
+        });
+        return {
+            files : response.files.map(f=>({
+                filename: f.filename,
+                data    : new Uint8Array(f.data)
+            })),
+            status: response.status
+        };
+    }
+
     // Reset simulation state
     reset() {
         return this.#core.toCore({
@@ -473,6 +538,16 @@ class Sim extends HTMLElement {
         });
     }
 
+    // Count the calls made by jal and jmp, emulating one clock at a time
+    setCallCounting(enabled) {
+        return this.#core.toCore({
+            command : "setCallCounting",
+            promised: true,
+            sim     : this.#pointer,
+            enabled : !!enabled
+        });
+    }
+
     // Specify a game pak RAM buffer
     setCartRAM(wram) {
         return this.#setCartMemory("setCartRAM", wram);
@@ -537,6 +612,47 @@ class Sim extends HTMLElement {
             await this.#core.setPeer(this, peer);
     }
 
+    // Sample the program counter every given number of clocks (0 = off)
+    setSampling(interval) {
+
+        // Error checking
+        if (!Number.isSafeInteger(interval) ||
+            interval < 0 || interval > 0xFFFFFFFF)
+            throw new RangeError("Interval must conform to Uint32.");
+
+        // Send the interval to the core
+        return this.#core.toCore({
+            command : "setSampling",
+            promised: true,
+            sim     : this.#pointer,
+            interval: interval
+        });
+    }
+
+    // Serve the semihosting mailbox of a program, with files it can open
+    setSemihosting(address, files = []) {
+
+        // Error checking
+        if (!Number.isSafeInteger(address) ||
+            address < 0 || address > 0xFFFFFFFF)
+            throw new RangeError("Address must conform to Uint32.");
+
+        // Send the mailbox and the files to the core
+        files = files.map(f=>({
+            filename: f.filename,
+            data    : (f.data instanceof ArrayBuffer ?
+                new Uint8Array(f.data) : Uint8Array.from(f.data)).slice().buffer
+        }));
+        return this.#core.toCore({
+            command  : "setSemihosting",
+            promised : true,
+            sim      : this.#pointer,
+            address  : address,
+            files    : files,
+            transfers: files.map(f=>f.data)
+        });
+    }
+
     // Specify audio volume
     setVolume(volume) {
 